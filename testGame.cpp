@@ -5,6 +5,8 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <fstream>
+#include <iomanip>
 
 const int SCREEN_WIDTH = 800;
 const int SCREEN_HEIGHT = 600;
@@ -169,6 +171,175 @@ struct Player {
     }
 };
 
+// Energy probe buckets: game states, with PLAYING split by whether the player is moving
+enum EnergyBucket {
+    ENERGY_MENU,
+    ENERGY_IDLE,
+    ENERGY_MOVING,
+    ENERGY_PAUSED,
+    ENERGY_BUCKET_COUNT
+};
+
+const char* const ENERGY_BUCKET_NAMES[ENERGY_BUCKET_COUNT] = {
+    "Main Menu", "Playing (idle)", "Playing (moving)", "Paused"
+};
+
+const char* const GAME_STATE_NAMES[] = {
+    "Main Menu", "Playing", "Paused", "Quit"
+};
+
+const char* const RAPL_ROOT = "/sys/class/powercap/intel-rapl:0";
+const float ENERGY_REPORT_INTERVAL = 5.0f; // Seconds between periodic energy reports
+
+EnergyBucket energyBucketFor(GameState state, bool playerMoving) {
+    if (state == PLAYING) return playerMoving ? ENERGY_MOVING : ENERGY_IDLE;
+    if (state == PAUSED) return ENERGY_PAUSED;
+    return ENERGY_MENU;
+}
+
+// Read a single integer value from a sysfs file
+bool readSysfsValue(const std::string& path, unsigned long long& value) {
+    std::ifstream file(path);
+    return static_cast<bool>(file >> value);
+}
+
+// One RAPL domain (package or core), read from powercap sysfs in microjoules
+struct RaplCounter {
+    std::string path;
+    unsigned long long maxRange; // energy_uj counts 0..maxRange inclusive, then wraps
+    unsigned long long last;
+    bool valid;
+
+    RaplCounter() : maxRange(0), last(0), valid(false) {}
+
+    bool open(const std::string& domainPath) {
+        path = domainPath + "/energy_uj";
+        // Without the range a wrapped counter can't be unwrapped, so the domain is unusable
+        valid = readSysfsValue(domainPath + "/max_energy_range_uj", maxRange) &&
+                readSysfsValue(path, last);
+        return valid;
+    }
+
+    // Joules consumed since the previous read
+    double readJoules() {
+        if (!valid) return 0.0;
+        unsigned long long now;
+        if (!readSysfsValue(path, now)) return 0.0;
+        unsigned long long delta = now >= last ? now - last : maxRange - last + now + 1;
+        last = now;
+        return delta / 1e6;
+    }
+};
+
+struct EnergyStats {
+    int frames;
+    double seconds;
+    double packageJoules;
+    double coreJoules;
+
+    EnergyStats() : frames(0), seconds(0), packageJoules(0), coreJoules(0) {}
+
+    void add(double frameSeconds, double pkg, double core) {
+        frames++;
+        seconds += frameSeconds;
+        packageJoules += pkg;
+        coreJoules += core;
+    }
+
+    void print(const char* label, bool hasCore) const {
+        if (frames == 0) return;
+        std::cout << std::fixed << std::setprecision(2)
+                  << "[energy] " << std::left << std::setw(16) << label << std::right
+                  << " frames=" << std::setw(6) << frames
+                  << "  avg frame=" << std::setw(6) << seconds * 1000.0 / frames << " ms"
+                  << "  pkg=" << std::setw(8) << std::setprecision(3) << packageJoules << " J ("
+                  << std::setw(6) << std::setprecision(2) << packageJoules * 1000.0 / frames << " mJ/frame, "
+                  << std::setw(5) << (seconds > 0 ? packageJoules / seconds : 0.0) << " W)"
+                  << "  core=";
+        if (hasCore) {
+            std::cout << std::setw(8) << std::setprecision(3) << coreJoules << " J";
+        } else {
+            std::cout << "n/a";
+        }
+        std::cout << std::defaultfloat << std::endl;
+    }
+};
+
+// Optional energy-per-frame measurement via Linux RAPL counters (enable with --energy)
+struct EnergyProbe {
+    bool enabled;
+    RaplCounter package;
+    RaplCounter core;
+    Uint64 lastCounter;
+    EnergyStats totals[ENERGY_BUCKET_COUNT];
+    EnergyStats interval;
+    GameState intervalState;
+
+    EnergyProbe() : enabled(false), lastCounter(0), intervalState(MAIN_MENU) {}
+
+    void init() {
+        if (!package.open(RAPL_ROOT)) {
+            std::cout << "Energy probe disabled: cannot read " << RAPL_ROOT
+                      << "/energy_uj (missing RAPL support or insufficient permissions)" << std::endl;
+            return;
+        }
+
+        // Core domain is one of the package's subzones, identified by its name
+        for (int i = 0; ; i++) {
+            std::string subzone = std::string(RAPL_ROOT) + "/intel-rapl:0:" + std::to_string(i);
+            std::ifstream nameFile(subzone + "/name");
+            if (!nameFile) break;
+            std::string name;
+            if (nameFile >> name && name == "core") {
+                if (!core.open(subzone)) {
+                    std::cout << "Energy probe: cannot read core domain " << subzone
+                              << ", reporting package energy only" << std::endl;
+                }
+                break;
+            }
+        }
+        if (!core.valid && core.path.empty()) {
+            std::cout << "Energy probe: no core RAPL domain found, reporting package energy only" << std::endl;
+        }
+
+        enabled = true;
+        lastCounter = SDL_GetPerformanceCounter();
+    }
+
+    // Attribute time and energy since the previous sample to the given state
+    void sample(GameState state, bool playerMoving) {
+        if (!enabled) return;
+
+        Uint64 now = SDL_GetPerformanceCounter();
+        double frameSeconds = static_cast<double>(now - lastCounter) / SDL_GetPerformanceFrequency();
+        lastCounter = now;
+
+        double pkg = package.readJoules();
+        double cpu = core.readJoules();
+        totals[energyBucketFor(state, playerMoving)].add(frameSeconds, pkg, cpu);
+
+        // Periodic report covers a single GameState; the idle/moving split is kept in the totals only
+        if (state != intervalState) {
+            interval.print(GAME_STATE_NAMES[intervalState], core.valid);
+            interval = EnergyStats();
+            intervalState = state;
+        }
+        interval.add(frameSeconds, pkg, cpu);
+        if (interval.seconds >= ENERGY_REPORT_INTERVAL) {
+            interval.print(GAME_STATE_NAMES[intervalState], core.valid);
+            interval = EnergyStats();
+        }
+    }
+
+    void printSummary() const {
+        if (!enabled) return;
+        std::cout << "[energy] Summary by state:" << std::endl;
+        for (int i = 0; i < ENERGY_BUCKET_COUNT; i++) {
+            totals[i].print(ENERGY_BUCKET_NAMES[i], core.valid);
+        }
+    }
+};
+
 struct Button {
     SDL_Rect rect;
     std::string text;
@@ -455,6 +626,11 @@ void renderGame(SDL_Renderer* renderer, const Player& player, const Camera& came
 int main(int argc, char* argv[]) {
     srand(static_cast<unsigned>(time(nullptr)));
 
+    bool measureEnergy = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--energy") measureEnergy = true;
+    }
+
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         std::cout << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return 1;
@@ -505,11 +681,18 @@ int main(int argc, char* argv[]) {
     Uint32 lastTime = SDL_GetTicks();
     int mouseX = 0, mouseY = 0;
 
+    EnergyProbe energyProbe;
+    if (measureEnergy) energyProbe.init();
+
     while (running) {
         Uint32 currentTime = SDL_GetTicks();
         float deltaTime = (currentTime - lastTime) / 1000.0f;
         lastTime = currentTime;
 
+        // State this frame is charged to, before events can change it
+        GameState frameState = gameState;
+        bool frameMoving = player.isMoving;
+
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
                 running = false;
@@ -611,8 +794,12 @@ int main(int argc, char* argv[]) {
         }
 
         SDL_Delay(16);
+
+        energyProbe.sample(frameState, frameMoving);
     }
 
+    energyProbe.printSummary();
+
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
     SDL_Quit();